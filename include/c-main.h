@@ -79,10 +79,8 @@ void *MLton_threadFunc (void* arg) {                                    \
                                                                         \
   /* Do not set CPU affinity when running on a single processor  */     \
   if (s->controls->setAffinity /* && s->numberOfProcs > 1*/) {          \
-      uint32_t num = Proc_processorNumber (s)                           \
-          * s->controls->affinityStride                                 \
-          + s->controls->affinityBase;                                  \
-      set_cpu_affinity(num);                                            \
+      int32_t cpu = GC_affinityForProc (s, Proc_processorNumber (s));   \
+      set_cpu_affinity(cpu);                                            \
   }                                                                     \
                                                                         \
   /* Save our state locally */                                          \
@@ -1,5 +1,38 @@
 #include "platform.h"
 #include "gdtoa/gdtoa.h"
+#include "basis/Real/grisu.h"
+
+/* Shortest digits rounded to nearest (mode 0, used by Real.toDecimal and
+ * Real.fmt EXACT) come from Grisu3, which needs no Bigint arithmetic.  So
+ * do the n significant digits of mode 2 (Real.toString and Real.fmt (GEN
+ * _), (SCI _)) whenever the shortest digits number at most n and n is at
+ * most REAL{32,64}_GRISU_MAX_DIG: the shortest digits are then also the correctly
+ * rounded n-digit ones, because x lies within half an ulp of them, and
+ * half an ulp is less than half a unit in the n-th digit.  That bound
+ * needs the full precision, so subnormals always take gdtoa in mode 2.
+ *
+ * Grisu3 writes into a per-thread buffer, which the ML side copies out
+ * before the next call on that thread (the call and the free run inside
+ * one atomic section); Real{32,64}_gdtoa_free leaves it alone and frees
+ * only gdtoa's own results.  Everything else goes through gdtoa as before.
+ */
+#define REAL32_GRISU_MAX_DIG 6
+#define REAL64_GRISU_MAX_DIG 15
+
+static __thread char grisuBuffer[32];
+
+static char *grisu_result (uint64_t f, int e, bool closerLo, bool normal,
+                           C_Int_t mode, C_Int_t ndig, int maxDig,
+                           Ref(C_Int_t) decpt) {
+  if (not (0 == mode
+           or (2 == mode and normal and 1 <= ndig and ndig <= maxDig)))
+    return NULL;
+  if (not grisu3 (f, e, closerLo, grisuBuffer, (int*)decpt))
+    return NULL;
+  if (2 == mode and strlen (grisuBuffer) > (size_t)ndig)
+    return NULL;
+  return grisuBuffer;
+}
 
 /* This code is patterned on g_ffmt from the gdtoa sources. */
 C_String_t Real32_gdtoa (Real32_t f, C_Int_t mode, C_Int_t ndig, 
@@ -16,13 +49,22 @@ C_String_t Real32_gdtoa (Real32_t f, C_Int_t mode, C_Int_t ndig,
   else
     ex = 1;
   ex -= 0x7f + 23;
+  if (1 == rounding and 0 != bits[0]) {
+    char *r = grisu_result (bits[0], ex,
+                            0x800000 == bits[0] and ex > 1-0x7f-23,
+                            0 != (bits[0] & 0x800000),
+                            mode, ndig, REAL32_GRISU_MAX_DIG, decpt);
+    if (NULL != r)
+      return (C_String_t)r;
+  }
   i = STRTOG_Normal;
   result = gdtoa__gdtoa (&fpi, ex, bits, &i, (int)mode, (int)ndig, (int*)decpt, NULL);
   return (C_String_t)result;
 }
 
 void Real32_gdtoa_free(C_String_t s) {
-  gdtoa__freedtoa((char*)s);
+  if ((char*)s != grisuBuffer)
+    gdtoa__freedtoa ((char*)s);
 }
 
 /* This code is patterned on g_dfmt from the gdtoa sources. */
@@ -49,11 +91,22 @@ C_String_t Real64_gdtoa (Real64_t d, C_Int_t mode, C_Int_t ndig,
   else
     ex = 1;
   ex -= 0x3ff + 52;
+  if (1 == rounding and (0 != bits[0] or 0 != bits[1])) {
+    uint64_t f = ((uint64_t)bits[1] << 32) | bits[0];
+    char *r = grisu_result (f, ex,
+                            UINT64_C(0x10000000000000) == f
+                            and ex > 1-0x3ff-52,
+                            0 != (bits[1] & 0x100000),
+                            mode, ndig, REAL64_GRISU_MAX_DIG, decpt);
+    if (NULL != r)
+      return (C_String_t)r;
+  }
   i = STRTOG_Normal;
   result = gdtoa__gdtoa (&fpi, ex, bits, &i, mode, ndig, (int*)decpt, NULL);
   return (C_String_t)result;
 }
 
 void Real64_gdtoa_free(C_String_t s) {
-  gdtoa__freedtoa((char*)s);
+  if ((char*)s != grisuBuffer)
+    gdtoa__freedtoa ((char*)s);
 }
@@ -0,0 +1,260 @@
+/* Grisu3 shortest round-trip formatting (Loitsch, "Printing
+ * Floating-Point Numbers Quickly and Accurately with Integers", PLDI
+ * 2010).  Grisu3 uses only 64-bit integer arithmetic and a static table
+ * of cached powers of ten, so it allocates nothing and touches no shared
+ * state.  For roughly 0.5% of inputs it cannot prove that its output is
+ * the shortest correctly rounded one; it then returns false and the
+ * caller falls back to gdtoa.
+ */
+
+typedef struct {
+  uint64_t f;
+  int e;
+} grisu_fp;
+
+typedef struct {
+  uint64_t f;
+  int16_t e;
+  int16_t k;
+} grisu_cached_power;
+
+/* Normalized 64-bit approximations (rounded to nearest) of 10^k for
+ * k = -348, -340, ..., 340: 10^k ~= f * 2^e.
+ */
+static const grisu_cached_power grisu_cached_powers[] = {
+  { UINT64_C(0xfa8fd5a0081c0288), -1220, -348 },
+  { UINT64_C(0xbaaee17fa23ebf76), -1193, -340 },
+  { UINT64_C(0x8b16fb203055ac76), -1166, -332 },
+  { UINT64_C(0xcf42894a5dce35ea), -1140, -324 },
+  { UINT64_C(0x9a6bb0aa55653b2d), -1113, -316 },
+  { UINT64_C(0xe61acf033d1a45df), -1087, -308 },
+  { UINT64_C(0xab70fe17c79ac6ca), -1060, -300 },
+  { UINT64_C(0xff77b1fcbebcdc4f), -1034, -292 },
+  { UINT64_C(0xbe5691ef416bd60c), -1007, -284 },
+  { UINT64_C(0x8dd01fad907ffc3c),  -980, -276 },
+  { UINT64_C(0xd3515c2831559a83),  -954, -268 },
+  { UINT64_C(0x9d71ac8fada6c9b5),  -927, -260 },
+  { UINT64_C(0xea9c227723ee8bcb),  -901, -252 },
+  { UINT64_C(0xaecc49914078536d),  -874, -244 },
+  { UINT64_C(0x823c12795db6ce57),  -847, -236 },
+  { UINT64_C(0xc21094364dfb5637),  -821, -228 },
+  { UINT64_C(0x9096ea6f3848984f),  -794, -220 },
+  { UINT64_C(0xd77485cb25823ac7),  -768, -212 },
+  { UINT64_C(0xa086cfcd97bf97f4),  -741, -204 },
+  { UINT64_C(0xef340a98172aace5),  -715, -196 },
+  { UINT64_C(0xb23867fb2a35b28e),  -688, -188 },
+  { UINT64_C(0x84c8d4dfd2c63f3b),  -661, -180 },
+  { UINT64_C(0xc5dd44271ad3cdba),  -635, -172 },
+  { UINT64_C(0x936b9fcebb25c996),  -608, -164 },
+  { UINT64_C(0xdbac6c247d62a584),  -582, -156 },
+  { UINT64_C(0xa3ab66580d5fdaf6),  -555, -148 },
+  { UINT64_C(0xf3e2f893dec3f126),  -529, -140 },
+  { UINT64_C(0xb5b5ada8aaff80b8),  -502, -132 },
+  { UINT64_C(0x87625f056c7c4a8b),  -475, -124 },
+  { UINT64_C(0xc9bcff6034c13053),  -449, -116 },
+  { UINT64_C(0x964e858c91ba2655),  -422, -108 },
+  { UINT64_C(0xdff9772470297ebd),  -396, -100 },
+  { UINT64_C(0xa6dfbd9fb8e5b88f),  -369,  -92 },
+  { UINT64_C(0xf8a95fcf88747d94),  -343,  -84 },
+  { UINT64_C(0xb94470938fa89bcf),  -316,  -76 },
+  { UINT64_C(0x8a08f0f8bf0f156b),  -289,  -68 },
+  { UINT64_C(0xcdb02555653131b6),  -263,  -60 },
+  { UINT64_C(0x993fe2c6d07b7fac),  -236,  -52 },
+  { UINT64_C(0xe45c10c42a2b3b06),  -210,  -44 },
+  { UINT64_C(0xaa242499697392d3),  -183,  -36 },
+  { UINT64_C(0xfd87b5f28300ca0e),  -157,  -28 },
+  { UINT64_C(0xbce5086492111aeb),  -130,  -20 },
+  { UINT64_C(0x8cbccc096f5088cc),  -103,  -12 },
+  { UINT64_C(0xd1b71758e219652c),   -77,   -4 },
+  { UINT64_C(0x9c40000000000000),   -50,    4 },
+  { UINT64_C(0xe8d4a51000000000),   -24,   12 },
+  { UINT64_C(0xad78ebc5ac620000),     3,   20 },
+  { UINT64_C(0x813f3978f8940984),    30,   28 },
+  { UINT64_C(0xc097ce7bc90715b3),    56,   36 },
+  { UINT64_C(0x8f7e32ce7bea5c70),    83,   44 },
+  { UINT64_C(0xd5d238a4abe98068),   109,   52 },
+  { UINT64_C(0x9f4f2726179a2245),   136,   60 },
+  { UINT64_C(0xed63a231d4c4fb27),   162,   68 },
+  { UINT64_C(0xb0de65388cc8ada8),   189,   76 },
+  { UINT64_C(0x83c7088e1aab65db),   216,   84 },
+  { UINT64_C(0xc45d1df942711d9a),   242,   92 },
+  { UINT64_C(0x924d692ca61be758),   269,  100 },
+  { UINT64_C(0xda01ee641a708dea),   295,  108 },
+  { UINT64_C(0xa26da3999aef774a),   322,  116 },
+  { UINT64_C(0xf209787bb47d6b85),   348,  124 },
+  { UINT64_C(0xb454e4a179dd1877),   375,  132 },
+  { UINT64_C(0x865b86925b9bc5c2),   402,  140 },
+  { UINT64_C(0xc83553c5c8965d3d),   428,  148 },
+  { UINT64_C(0x952ab45cfa97a0b3),   455,  156 },
+  { UINT64_C(0xde469fbd99a05fe3),   481,  164 },
+  { UINT64_C(0xa59bc234db398c25),   508,  172 },
+  { UINT64_C(0xf6c69a72a3989f5c),   534,  180 },
+  { UINT64_C(0xb7dcbf5354e9bece),   561,  188 },
+  { UINT64_C(0x88fcf317f22241e2),   588,  196 },
+  { UINT64_C(0xcc20ce9bd35c78a5),   614,  204 },
+  { UINT64_C(0x98165af37b2153df),   641,  212 },
+  { UINT64_C(0xe2a0b5dc971f303a),   667,  220 },
+  { UINT64_C(0xa8d9d1535ce3b396),   694,  228 },
+  { UINT64_C(0xfb9b7cd9a4a7443c),   720,  236 },
+  { UINT64_C(0xbb764c4ca7a44410),   747,  244 },
+  { UINT64_C(0x8bab8eefb6409c1a),   774,  252 },
+  { UINT64_C(0xd01fef10a657842c),   800,  260 },
+  { UINT64_C(0x9b10a4e5e9913129),   827,  268 },
+  { UINT64_C(0xe7109bfba19c0c9d),   853,  276 },
+  { UINT64_C(0xac2820d9623bf429),   880,  284 },
+  { UINT64_C(0x80444b5e7aa7cf85),   907,  292 },
+  { UINT64_C(0xbf21e44003acdd2d),   933,  300 },
+  { UINT64_C(0x8e679c2f5e44ff8f),   960,  308 },
+  { UINT64_C(0xd433179d9c8cb841),   986,  316 },
+  { UINT64_C(0x9e19db92b4e31ba9),  1013,  324 },
+  { UINT64_C(0xeb96bf6ebadf77d9),  1039,  332 },
+  { UINT64_C(0xaf87023b9bf0ee6b),  1066,  340 },
+};
+
+#define GRISU_CACHED_POWERS_OFFSET 348
+#define GRISU_CACHED_POWERS_STEP 8
+#define GRISU_MIN_TARGET_EXP (-60)
+#define GRISU_MAX_TARGET_EXP (-32)
+
+static inline grisu_fp grisu_fp_mul (grisu_fp x, grisu_fp y) {
+  const uint64_t M32 = 0xFFFFFFFFu;
+  uint64_t a = x.f >> 32, b = x.f & M32;
+  uint64_t c = y.f >> 32, d = y.f & M32;
+  uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+  /* Round the 128-bit product to its upper 64 bits. */
+  uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32) + (UINT64_C(1) << 31);
+  grisu_fp r;
+  r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+  r.e = x.e + y.e + 64;
+  return r;
+}
+
+static inline grisu_fp grisu_fp_normalize (grisu_fp x) {
+  while (0 == (x.f & (UINT64_C(1) << 63))) {
+    x.f <<= 1;
+    x.e--;
+  }
+  return x;
+}
+
+/* Set *w to the normalized value f * 2^e and *lo, *hi to the normalized
+ * midpoints between it and its neighbours, all sharing w's exponent.
+ * 'closerLo' holds when f is a power of two above the smallest normal,
+ * where the gap to the predecessor is half the gap to the successor.
+ */
+static inline void grisu_boundaries (uint64_t f, int e, bool closerLo,
+                                     grisu_fp *lo, grisu_fp *w, grisu_fp *hi) {
+  grisu_fp v = { f, e };
+  grisu_fp p = { (f << 1) + 1, e - 1 };
+  grisu_fp m;
+
+  *w = grisu_fp_normalize (v);
+  *hi = grisu_fp_normalize (p);
+  if (closerLo) {
+    m.f = (f << 2) - 1;
+    m.e = e - 2;
+  } else {
+    m.f = (f << 1) - 1;
+    m.e = e - 1;
+  }
+  m.f <<= m.e - hi->e;
+  m.e = hi->e;
+  *lo = m;
+}
+
+static inline bool grisu_round_weed (char *buf, int len,
+                                     uint64_t distTooHighW, uint64_t unsafe,
+                                     uint64_t rest, uint64_t tenKappa,
+                                     uint64_t unit) {
+  uint64_t small = distTooHighW - unit;
+  uint64_t big = distTooHighW + unit;
+
+  while (rest < small
+         and unsafe - rest >= tenKappa
+         and (rest + tenKappa < small
+              or small - rest >= rest + tenKappa - small)) {
+    buf[len - 1]--;
+    rest += tenKappa;
+  }
+  if (rest < big
+      and unsafe - rest >= tenKappa
+      and (rest + tenKappa < big
+           or big - rest > rest + tenKappa - big))
+    return false;
+  return (2 * unit <= rest) and (rest <= unsafe - 4 * unit);
+}
+
+static inline bool grisu_digit_gen (grisu_fp lo, grisu_fp w, grisu_fp hi,
+                                    char *buf, int *len, int *kappa) {
+  uint64_t unit = 1;
+  uint64_t tooLow = lo.f - unit;
+  uint64_t tooHigh = hi.f + unit;
+  uint64_t unsafe = tooHigh - tooLow;
+  int shift = -w.e;
+  uint64_t one = UINT64_C(1) << shift;
+  uint32_t integrals = (uint32_t)(tooHigh >> shift);
+  uint64_t fractionals = tooHigh & (one - 1);
+  uint32_t divisor = 1000000000;
+
+  *kappa = 10;
+  while (*kappa > 0 and integrals < divisor) {
+    divisor /= 10;
+    (*kappa)--;
+  }
+  *len = 0;
+  while (*kappa > 0) {
+    uint64_t rest;
+    buf[(*len)++] = (char)('0' + integrals / divisor);
+    integrals %= divisor;
+    (*kappa)--;
+    rest = ((uint64_t)integrals << shift) + fractionals;
+    if (rest < unsafe)
+      return grisu_round_weed (buf, *len, tooHigh - w.f, unsafe, rest,
+                               (uint64_t)divisor << shift, unit);
+    divisor /= 10;
+  }
+  for (;;) {
+    fractionals *= 10;
+    unit *= 10;
+    unsafe *= 10;
+    buf[(*len)++] = (char)('0' + (fractionals >> shift));
+    fractionals &= one - 1;
+    (*kappa)--;
+    if (fractionals < unsafe)
+      return grisu_round_weed (buf, *len, (tooHigh - w.f) * unit, unsafe,
+                               fractionals, one, unit);
+  }
+}
+
+/* Shortest digits of the positive value f * 2^e into buf (at least 32
+ * bytes), NUL-terminated and without trailing zeros; *decpt is set as
+ * by gdtoa, so the value is 0.<buf> * 10^*decpt.
+ */
+static bool grisu3 (uint64_t f, int e, bool closerLo,
+                    char *buf, int *decpt) {
+  grisu_fp lo, w, hi, c;
+  const grisu_cached_power *cp;
+  int minExp, k, idx, len, kappa;
+
+  grisu_boundaries (f, e, closerLo, &lo, &w, &hi);
+  minExp = GRISU_MIN_TARGET_EXP - (w.e + 64);
+  /* k = ceil ((minExp + 63) * log10 2) */
+  k = (int)ceil ((minExp + 63) * 0.30102999566398114);
+  idx = (GRISU_CACHED_POWERS_OFFSET + k - 1) / GRISU_CACHED_POWERS_STEP + 1;
+  if (idx < 0 or idx >= (int)(sizeof(grisu_cached_powers)
+                              / sizeof(grisu_cached_powers[0])))
+    return false;
+  cp = &grisu_cached_powers[idx];
+  if (cp->e < minExp or cp->e > GRISU_MAX_TARGET_EXP - (w.e + 64))
+    return false;
+  c.f = cp->f;
+  c.e = cp->e;
+  if (not grisu_digit_gen (grisu_fp_mul (lo, c), grisu_fp_mul (w, c),
+                           grisu_fp_mul (hi, c), buf, &len, &kappa))
+    return false;
+  *decpt = len + kappa - cp->k;
+  while (len > 1 and buf[len - 1] == '0')
+    len--;
+  buf[len] = '\0';
+  return true;
+}
@@ -1,10 +1,67 @@
 #include "platform.h"
 #include "gdtoa/gdtoa.h"
+#include "basis/Real/eisel-lemire.h"
 
+/* Real.fromString and Real.fromDecimal pass strings of the form
+ * [-]0.<digits>E[-]<exp> (see fromDecimalWithRoundingMode).  Split one
+ * into sign, significand and decimal exponent, so that its value is
+ * w * 10^q.  Returns false for anything else, and when the significand
+ * has more than 19 significant digits and so may not fit in w.
+ */
+static bool parseDecimal (const char *s, bool *neg, uint64_t *w, int *q) {
+  uint64_t m = 0;
+  int digits = 0, sig = 0, expDigits = 0;
+  long exp = 0;
+  bool expNeg = false;
+
+  *neg = ('-' == *s);
+  if (*neg)
+    s++;
+  if ('0' != s[0] or '.' != s[1])
+    return false;
+  for (s += 2; '0' <= *s and *s <= '9'; s++, digits++) {
+    if (0 == sig and '0' == *s)
+      continue;
+    if (++sig > 19)
+      return false;
+    m = 10 * m + (uint64_t)(*s - '0');
+  }
+  if ('E' != *s++)
+    return false;
+  if ('-' == *s) {
+    expNeg = true;
+    s++;
+  }
+  for (; '0' <= *s and *s <= '9'; s++) {
+    if (++expDigits > 6)
+      return false;
+    exp = 10 * exp + (*s - '0');
+  }
+  if ('\0' != *s or 0 == expDigits)
+    return false;
+  *w = m;
+  *q = (int)((expNeg ? -exp : exp) - digits);
+  return true;
+}
+
+/* Round-to-nearest conversions of short significands are done with
+ * Eisel-Lemire, which needs no Bigint arithmetic; everything else, and
+ * anything Eisel-Lemire cannot decide, goes through gdtoa.
+ */
 Real32_t Real32_strtor (NullString8_t s, C_Int_t rounding) {
   char *endptr;
   Real32_t res;
+  uint64_t w, bits;
+  int q;
+  bool neg;
 
+  if (1 == rounding
+      and parseDecimal ((const char*)s, &neg, &w, &q)
+      and eisel_lemire (&eisel_lemire_binary32, w, q, &bits)) {
+    uint32_t b = (uint32_t)bits | ((uint32_t)neg << 31);
+    memcpy (&res, &b, sizeof(Real32_t));
+    return res;
+  }
   gdtoa__strtorf ((const char*)s, &endptr, (int)rounding, &res);
   assert (NULL != endptr);
   return res;
@@ -13,7 +70,17 @@ Real32_t Real32_strtor (NullString8_t s, C_Int_t rounding) {
 Real64_t Real64_strtor (NullString8_t s, C_Int_t rounding) {
   char *endptr;
   Real64_t res;
+  uint64_t w, bits;
+  int q;
+  bool neg;
 
+  if (1 == rounding
+      and parseDecimal ((const char*)s, &neg, &w, &q)
+      and eisel_lemire (&eisel_lemire_binary64, w, q, &bits)) {
+    bits |= (uint64_t)neg << 63;
+    memcpy (&res, &bits, sizeof(Real64_t));
+    return res;
+  }
   gdtoa__strtord ((const char*)s, &endptr, (int)rounding, &res);
   assert (NULL != endptr);
   return res;
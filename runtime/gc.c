@@ -56,6 +56,7 @@ extern C_Pthread_Key_t gcstate_key;
 #include "gc/concurrent-collection.c"
 #include "gc/concurrent-stack.c"
 #include "gc/controls.c"
+#include "gc/cpus.c"
 #include "gc/copy-thread.c"
 #include "gc/current.c"
 #include "gc/entanglement-suspects.c"
@@ -92,6 +93,7 @@ extern C_Pthread_Key_t gcstate_key;
 #include "gc/objptr.c"
 #include "gc/pack.c"
 #include "gc/parallel.c"
+#include "gc/park.c"
 #include "gc/pin.c"
 #include "gc/pointer.c"
 #include "gc/profiling.c"
@@ -103,6 +105,7 @@ extern C_Pthread_Key_t gcstate_key;
 #include "gc/sequence.c"
 #include "gc/share.c"
 #include "gc/signals.c"
+#include "gc/simd.c"
 #include "gc/size.c"
 #include "gc/sources.c"
 #include "gc/stack.c"
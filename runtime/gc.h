@@ -55,6 +55,7 @@ typedef GC_state GCState_t;
 #include "gc/heap.h"
 #include "gc/current.h"
 #include "gc/sysvals.h"
+#include "gc/cpus.h"
 #include "gc/controls.h"
 #include "gc/major.h"
 #include "gc/statistics.h"
@@ -82,6 +83,7 @@ typedef GC_state GCState_t;
 #include "gc/size.h"
 #include "gc/share.h"
 #include "gc/parallel.h"
+#include "gc/park.h"
 #include "gc/processor.h"
 #include "gc/pin.h"
 #include "gc/hierarchical-heap.h"
@@ -97,6 +99,7 @@ typedef GC_state GCState_t;
 #include "gc/concurrent-list.h"
 #include "gc/remembered-set.h"
 #include "gc/gap.h"
+#include "gc/simd.h"
 // #include "gc/deferred-promote.h"
 #include "gc/tracing-hooks.h"
 
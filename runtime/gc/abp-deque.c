@@ -108,7 +108,7 @@ objptr ABP_deque_try_pop_bot(
 
 
 objptr ABP_deque_try_pop_top(
-  __attribute__ ((unused)) GC_state s,
+  GC_state s,
   objptr top_op,
   objptr bot_op,
   objptr data_op,
@@ -134,6 +134,8 @@ objptr ABP_deque_try_pop_top(
 
   if (__sync_bool_compare_and_swap(top, local_top, desired_top)) {
     ABP_deque_check_successful_pop(elem, fail_value);
+    /* only thieves pop from the top */
+    s->cumulativeStatistics->numSteals++;
     return elem;
   }
   else {
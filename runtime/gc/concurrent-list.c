@@ -1,7 +1,48 @@
+/* The list is lock-free. Its state is the pair (firstChunk, lastChunk),
+ * and the two fields change in a fixed order:
+ *   - The first chunk of an empty list is installed by claiming firstChunk
+ *     with a CAS from NULL, then publishing lastChunk. So firstChunk is
+ *     never NULL while lastChunk is not.
+ *   - Later chunks are installed with a single CAS on lastChunk. The new
+ *     chunk's prevChunk is set beforehand, so the prevChunk links are
+ *     always complete. The nextChunk link of the old last chunk is written
+ *     by the installer afterwards and may briefly lag behind lastChunk (see
+ *     CC_getNextChunk). Nobody else ever writes it.
+ *   - Popping swaps lastChunk to NULL, waits until every nextChunk link
+ *     up to the popped last chunk is published, and only then releases
+ *     firstChunk and takes ownership of the chain.
+ */
 void CC_initConcList(CC_concList concList) {
   concList->firstChunk = NULL;
   concList->lastChunk = NULL;
-  pthread_mutex_init(&(concList->mutex), NULL);
+}
+
+
+/* Try to link the chain first..last onto the end of concList, whose last
+ * chunk was observed to be `expected`. Fails if another thread changed the
+ * end of the list in the meantime.
+ */
+static bool tryLinkChunks(
+  CC_concList concList,
+  HM_chunk expected,
+  HM_chunk first,
+  HM_chunk last)
+{
+  first->prevChunk = expected;
+
+  if (NULL == expected) {
+    if (!__sync_bool_compare_and_swap(&(concList->firstChunk), NULL, first)) {
+      return FALSE;
+    }
+    __atomic_store_n(&(concList->lastChunk), last, __ATOMIC_SEQ_CST);
+    return TRUE;
+  }
+
+  if (!__sync_bool_compare_and_swap(&(concList->lastChunk), expected, last)) {
+    return FALSE;
+  }
+  __atomic_store_n(&(expected->nextChunk), first, __ATOMIC_SEQ_CST);
+  return TRUE;
 }
 
 
@@ -13,9 +54,12 @@ void allocateChunkInConcList(
 {
   GC_state s = pthread_getspecific(gcstate_key);
 
-  // pthread_mutex_lock(&concList->mutex);
-  if(concList->lastChunk != lastChunk) {
-    // pthread_mutex_unlock(&concList->mutex);
+  if (concList->lastChunk != lastChunk) {
+    return;
+  }
+  if (NULL == lastChunk && NULL != concList->firstChunk) {
+    /* A first chunk is being installed, or a pop is releasing the list.
+     * Either finishes promptly; don't allocate a chunk just to lose. */
     return;
   }
 
@@ -32,45 +76,16 @@ void allocateChunkInConcList(
   assert((size_t)(chunk->limit - chunk->frontier) >= objSize);
   assert(chunk != NULL);
 
-  chunk->prevChunk = lastChunk;
-  // if (lastChunk != NULL)
-  // {
-  //   lastChunk->nextChunk = chunk;
-  // }
-  // concList->lastChunk = chunk;
-
   memset((void *)HM_getChunkStart(chunk), '\0', HM_getChunkLimit(chunk) - HM_getChunkStart(chunk));
 
-  bool success = false;
-  if(concList->lastChunk == lastChunk) {
-    pthread_mutex_lock(&concList->mutex);
-    if (concList->lastChunk == lastChunk) {
-      if (concList->firstChunk == NULL) {
-        concList->firstChunk = chunk;
-      }
-      if(lastChunk != NULL) {
-        lastChunk->nextChunk = chunk;
-      }
-      concList->lastChunk = chunk;
-      success = true;
-    }
-    pthread_mutex_unlock(&concList->mutex);
-  }
-  if (!success) {
+  if (!tryLinkChunks(concList, lastChunk, chunk, chunk)) {
     HM_freeChunkWithInfo(s, chunk, NULL, purpose);
   }
-
-  // if (!__sync_bool_compare_and_swap(&(concList->lastChunk), lastChunk, chunk)) {
-  //   HM_freeChunk(s, chunk);
-  // } else if (lastChunk != NULL) {
-  //   lastChunk->nextChunk = chunk;
-  // }
 }
 
 
 pointer CC_storeInConcListWithPurpose(CC_concList concList, void* p, size_t objSize, enum BlockPurpose purpose){
   assert(concList != NULL);
-  // pthread_mutex_lock(&concList->mutex);
   while(TRUE) {
     HM_chunk chunk = concList->lastChunk;
     if (NULL == chunk) {
@@ -90,12 +105,10 @@ pointer CC_storeInConcListWithPurpose(CC_concList concList, void* p, size_t objS
       if (success)
       {
         memcpy(frontier, p, objSize);
-        // pthread_mutex_unlock(&concList->mutex);
         return frontier;
       }
     }
   }
-  // pthread_mutex_unlock(&concList->mutex);
   DIE("should never come here");
   return NULL;
 }
@@ -172,49 +185,81 @@ pointer CC_storeInConcListWithPurpose(CC_concList concList, void* p, size_t objS
 // }
 
 void CC_popAsChunkList(CC_concList concList, HM_chunkList chunkList) {
-  pthread_mutex_lock(&concList->mutex);
-  chunkList->firstChunk = concList->firstChunk;
-  concList->firstChunk = NULL;
-  chunkList->lastChunk = concList->lastChunk;
-  concList->lastChunk = NULL;
-  pthread_mutex_unlock(&concList->mutex);
+  HM_chunk lastChunk =
+    __atomic_exchange_n(&(concList->lastChunk), NULL, __ATOMIC_SEQ_CST);
+
+  if (NULL == lastChunk) {
+    /* Empty, or a first chunk is still being installed; in that case the
+     * chunk belongs to the next pop. */
+    chunkList->firstChunk = NULL;
+    chunkList->lastChunk = NULL;
+    return;
+  }
+
+  HM_chunk firstChunk = __atomic_load_n(&(concList->firstChunk), __ATOMIC_SEQ_CST);
+  assert(NULL != firstChunk);
+
+  /* An installer whose CAS on lastChunk succeeded before the exchange may
+   * not have written the nextChunk link of its predecessor yet. Wait for
+   * it, as CC_getNextChunk does: once the chain is handed out it may be
+   * freed, and a late store would land in freed memory. */
+  HM_chunk chunk = firstChunk;
+  while (chunk != lastChunk) {
+    HM_chunk next = __atomic_load_n(&(chunk->nextChunk), __ATOMIC_SEQ_CST);
+    if (NULL != next) {
+      chunk = next;
+    }
+  }
+
+  __atomic_store_n(&(concList->firstChunk), NULL, __ATOMIC_SEQ_CST);
+  chunkList->firstChunk = firstChunk;
+  chunkList->lastChunk = lastChunk;
 }
 
 HM_chunk CC_getLastChunk (CC_concList concList) {
-  HM_chunk c;
-  pthread_mutex_lock(&concList->mutex);
-  c = concList->lastChunk;
-  pthread_mutex_unlock(&concList->mutex);
-  return c;
+  return __atomic_load_n(&(concList->lastChunk), __ATOMIC_SEQ_CST);
 }
 
-void CC_appendConcList(CC_concList concList1, CC_concList concList2) {
+HM_chunk CC_getNextChunk (CC_concList concList, HM_chunk chunk) {
+  while (TRUE) {
+    HM_chunk next = __atomic_load_n(&(chunk->nextChunk), __ATOMIC_SEQ_CST);
+    if (NULL != next) {
+      return next;
+    }
+    HM_chunk lastChunk = CC_getLastChunk(concList);
+    if (lastChunk == chunk || NULL == lastChunk) {
+      return NULL;
+    }
+    /* chunk has a successor whose link is still being written. */
+  }
+}
 
-  HM_chunk firstChunk, lastChunk;
-  pthread_mutex_lock(&concList2->mutex);
-  firstChunk = concList2->firstChunk;
-  lastChunk = concList2->lastChunk;
-  concList2->firstChunk = NULL;
-  concList2->lastChunk = NULL;
-  pthread_mutex_unlock(&concList2->mutex);
+void CC_appendConcList(CC_concList concList1, CC_concList concList2) {
+  struct HM_chunkList _chunkList;
+  HM_chunkList chunkList = &(_chunkList);
+  CC_popAsChunkList(concList2, chunkList);
 
+  HM_chunk firstChunk = chunkList->firstChunk;
+  HM_chunk lastChunk = chunkList->lastChunk;
   if (firstChunk == NULL || lastChunk == NULL) {
     return;
   }
 
-
-  pthread_mutex_lock(&concList1->mutex);
-  if (concList1->lastChunk == NULL) {
-    concList1->firstChunk = firstChunk;
-    concList1->lastChunk = lastChunk;
-  }
-  else {
-    concList1->lastChunk->nextChunk = firstChunk;
-    concList1->lastChunk->retireChunk = true;
-    firstChunk->prevChunk = concList1->lastChunk;
-    concList1->lastChunk = lastChunk;
+  while (TRUE) {
+    HM_chunk expected = CC_getLastChunk(concList1);
+    if (NULL == expected && NULL != concList1->firstChunk) {
+      continue;
+    }
+    /* Mark the old last chunk before the spliced chain becomes reachable
+     * from it, so that HM_foreachPublic treats it as fishy. If the CAS
+     * fails, the mark only costs that scan a recheck. */
+    if (NULL != expected) {
+      expected->retireChunk = true;
+    }
+    if (tryLinkChunks(concList1, expected, firstChunk, lastChunk)) {
+      return;
+    }
   }
-  pthread_mutex_unlock(&concList1->mutex);
 }
 
 void CC_freeChunksInConcListWithInfo(GC_state s, CC_concList concList, void *info, enum BlockPurpose purpose) {
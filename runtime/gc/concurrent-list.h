@@ -17,7 +17,6 @@ typedef struct CC_concList * CC_concList;
 struct CC_concList {
   HM_chunk firstChunk;
   HM_chunk lastChunk;
-  pthread_mutex_t mutex;
 };
 
 #endif /* MLTON_GC_INTERNAL_TYPES */
@@ -32,6 +31,9 @@ pointer CC_storeInConcListWithPurpose(CC_concList concList, void* p, size_t objS
 void CC_popAsChunkList(CC_concList concList, HM_chunkList chunkList);
 
 HM_chunk CC_getLastChunk (CC_concList concList);
+/* Successor of a chunk in the list, waiting out a link that is still being
+ * written; NULL if chunk is last, or the list was popped. */
+HM_chunk CC_getNextChunk (CC_concList concList, HM_chunk chunk);
 void CC_freeChunksInConcListWithInfo(GC_state s, CC_concList concList, void *info, enum BlockPurpose purpose);
 void CC_appendConcList(CC_concList concList1, CC_concList concList2);
 
@@ -63,6 +63,9 @@ struct GC_controls {
   int heartbeatMicroseconds;
   uint32_t heartbeatTokens; /* number of tokens generated per heartbeat */
   int heartbeatRelayerThreshold;
+  /* Promotable frames are found by walking the stack, because the program
+   * was compiled with -lazy-promotion and does not maintain promo stacks. */
+  bool lazyPromotion;
   size_t allocChunkSize;
   size_t blockSize;
   size_t allocBlocksMinSize;
@@ -76,6 +79,12 @@ struct GC_controls {
   bool setAffinity; /* whether or not to set processor affinity */
   int32_t affinityBase; /* First processor to use when setting affinity */
   int32_t affinityStride; /* Number of processors between first and second */
+  bool affinityExplicit; /* affinity-base or affinity-stride was given */
+  bool affinitySkipSMT; /* use one hardware thread per core */
+  bool procsAuto; /* choose the number of processors from cpuInfo */
+  uint32_t activeProcs; /* initial active-processor limit, 0 for all */
+  bool activeProcsAuto; /* let the scheduler adjust the limit from idle time */
+  struct GC_cpuInfo cpuInfo;
   struct GC_ratios ratios;
   struct HM_HierarchicalHeapConfig hhConfig;
   bool rusageMeasureGC;
@@ -0,0 +1,247 @@
+/* Detecting the processors available to this process.
+ *
+ * The allowed CPUs are those in the affinity mask the process starts with,
+ * which reflects the cpuset of its container. With `affinity-skip-smt` only
+ * the first allowed hardware thread of each physical core is kept. The
+ * cgroup v2 CPU quota (`cpu.max`) is the smallest limit found on the path
+ * from the process's cgroup up to the root.
+ *
+ * `@mpl procs auto` runs one worker per allowed CPU, but no more than the
+ * quota rounded up. Unless `affinity-base` or `affinity-stride` is given,
+ * `set-affinity` pins worker i to the i-th allowed CPU.
+ */
+
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+#if defined(__linux__)
+
+static bool readSysUint(const char *path, uint32_t *result) {
+  FILE *f = fopen(path, "r");
+  if (NULL == f)
+    return FALSE;
+  bool ok = (1 == fscanf(f, "%"SCNu32, result));
+  fclose(f);
+  return ok;
+}
+
+/* Keep only the first allowed hardware thread of each core. */
+static uint32_t skipSMTSiblings(uint32_t *cpus, uint32_t numCpus) {
+  uint32_t *cores = malloc_safe(2 * numCpus * sizeof(uint32_t));
+  uint32_t kept = 0;
+  char path[128];
+
+  for (uint32_t i = 0; i < numCpus; i++) {
+    uint32_t package, core;
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu%"PRIu32"/topology/physical_package_id",
+             cpus[i]);
+    bool known = readSysUint(path, &package);
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu%"PRIu32"/topology/core_id",
+             cpus[i]);
+    known = known and readSysUint(path, &core);
+    if (not known) {
+      /* without topology information, treat every CPU as its own core */
+      package = UINT32_MAX;
+      core = cpus[i];
+    }
+
+    bool seen = FALSE;
+    for (uint32_t j = 0; j < kept and not seen; j++)
+      seen = (cores[2*j] == package and cores[2*j+1] == core);
+    if (not seen) {
+      cores[2*kept] = package;
+      cores[2*kept+1] = core;
+      cpus[kept] = cpus[i];
+      kept++;
+    }
+  }
+
+  free(cores);
+  return kept;
+}
+
+static double readCgroupQuota(void) {
+  FILE *f = fopen("/proc/self/cgroup", "r");
+  if (NULL == f)
+    return 0.0;
+
+  /* cgroup v2 has a single hierarchy, listed as "0::<path>" */
+  char line[4096];
+  char dir[4096];
+  bool found = FALSE;
+  while (not found and NULL != fgets(line, sizeof(line), f)) {
+    if (0 == strncmp(line, "0::", 3)) {
+      line[strcspn(line, "\n")] = '\0';
+      snprintf(dir, sizeof(dir), "%s", line + 3);
+      found = TRUE;
+    }
+  }
+  fclose(f);
+  if (not found)
+    return 0.0;
+
+  double quota = 0.0;
+  while (TRUE) {
+    char path[4200];
+    char max[32];
+    uintmax_t period;
+    snprintf(path, sizeof(path), "/sys/fs/cgroup%s/cpu.max",
+             (0 == strcmp(dir, "/")) ? "" : dir);
+    FILE *cf = fopen(path, "r");
+    if (NULL != cf) {
+      if (2 == fscanf(cf, "%31s %"SCNuMAX, max, &period)
+          and 0 != strcmp(max, "max")
+          and period > 0) {
+        double q = strtod(max, NULL) / (double)period;
+        if (q > 0.0 and (0.0 == quota or q < quota))
+          quota = q;
+      }
+      fclose(cf);
+    }
+
+    char *slash = strrchr(dir, '/');
+    if (NULL == slash or 0 == strcmp(dir, "/"))
+      break;
+    if (slash == dir)
+      dir[1] = '\0';
+    else
+      *slash = '\0';
+  }
+
+  return quota;
+}
+
+#endif /* defined(__linux__) */
+
+uint32_t packageForProc(GC_state s, uint32_t proc) {
+#if defined(__linux__)
+  if (s->controls->setAffinity) {
+    uint32_t package;
+    char path[128];
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu%"PRId32"/topology/physical_package_id",
+             GC_affinityForProc(s, proc));
+    if (readSysUint(path, &package))
+      return package;
+  }
+#endif
+  (void)s;
+  (void)proc;
+  return UINT32_MAX;
+}
+
+void detectCpus(GC_state s) {
+  struct GC_cpuInfo *info = &(s->controls->cpuInfo);
+  info->cpus = NULL;
+  info->numCpus = 0;
+  info->cgroupQuota = 0.0;
+
+#if defined(__linux__)
+  cpu_set_t set;
+  if (0 == sched_getaffinity(0, sizeof(set), &set)) {
+    info->cpus = malloc_safe(CPU_COUNT(&set) * sizeof(uint32_t));
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+      if (CPU_ISSET(cpu, &set))
+        info->cpus[info->numCpus++] = cpu;
+    if (s->controls->affinitySkipSMT)
+      info->numCpus = skipSMTSiblings(info->cpus, info->numCpus);
+  }
+  info->cgroupQuota = readCgroupQuota();
+#endif
+
+  if (0 == info->numCpus) {
+    long n = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1)
+      n = 1;
+#endif
+    info->cpus = malloc_safe((size_t)n * sizeof(uint32_t));
+    for (long cpu = 0; cpu < n; cpu++)
+      info->cpus[info->numCpus++] = (uint32_t)cpu;
+  }
+}
+
+uint32_t autoNumberOfProcs(GC_state s) {
+  struct GC_cpuInfo *info = &(s->controls->cpuInfo);
+  uint32_t n = info->numCpus;
+  if (info->cgroupQuota > 0.0 and info->cgroupQuota < (double)n) {
+    /* round up: a quota of 2.5 CPUs gets 3 workers */
+    uint32_t q = (uint32_t)info->cgroupQuota;
+    if ((double)q < info->cgroupQuota)
+      q++;
+    n = q;
+  }
+  return (n < 1) ? 1 : n;
+}
+
+/* Warn when `set-affinity` would pin more than one worker to a CPU: with
+ * the default mapping, worker i goes to cpus[i % numCpus]. */
+void checkAffinity(GC_state s) {
+  struct GC_cpuInfo *info = &(s->controls->cpuInfo);
+  if (not s->controls->setAffinity)
+    return;
+  if (s->controls->affinityExplicit) {
+    for (uint32_t p = 0; p < s->numberOfProcs; p++) {
+      int32_t cpu = GC_affinityForProc(s, p);
+      bool allowed = FALSE;
+      for (uint32_t i = 0; i < info->numCpus and not allowed; i++)
+        allowed = ((int32_t)info->cpus[i] == cpu);
+      if (not allowed)
+        fprintf(stderr,
+                "[GC: warning: set-affinity pins worker %"PRIu32" to cpu %"PRId32
+                ", which this process may not use.]\n",
+                p, cpu);
+    }
+  } else if (s->numberOfProcs > info->numCpus) {
+    fprintf(stderr,
+            "[GC: warning: set-affinity pins %"PRIu32" workers to %"PRIu32
+            " cpus, so some cpus run more than one worker.]\n",
+            s->numberOfProcs, info->numCpus);
+  }
+}
+
+void displayCpuInfo(FILE *out, GC_state s) {
+  struct GC_cpuInfo *info = &(s->controls->cpuInfo);
+  fprintf(out, "procs: %"PRIu32"%s\n",
+          s->numberOfProcs,
+          s->controls->procsAuto ? " (auto)" : "");
+  fprintf(out, "available cpus: %"PRIu32"%s\n",
+          info->numCpus,
+          s->controls->affinitySkipSMT ? " (one per core)" : "");
+  if (info->cgroupQuota > 0.0)
+    fprintf(out, "cgroup cpu quota: %.2f\n", info->cgroupQuota);
+  else
+    fprintf(out, "cgroup cpu quota: none\n");
+  if (s->controls->setAffinity) {
+    fprintf(out, "affinity:");
+    for (uint32_t p = 0; p < s->numberOfProcs; p++)
+      fprintf(out, " %"PRId32, GC_affinityForProc(s, p));
+    fprintf(out, "\n");
+  }
+}
+
+void displayCpuInfoJSON(FILE *out, GC_state s) {
+  struct GC_cpuInfo *info = &(s->controls->cpuInfo);
+  fprintf(out, "\"procs\" : %"PRIu32, s->numberOfProcs);
+  fprintf(out, ", \"procsAuto\" : %s", s->controls->procsAuto ? "true" : "false");
+  fprintf(out, ", \"availableCpus\" : %"PRIu32, info->numCpus);
+  fprintf(out, ", \"cgroupCpuQuota\" : %f", info->cgroupQuota);
+  if (s->controls->setAffinity) {
+    fprintf(out, ", \"affinity\" : [");
+    for (uint32_t p = 0; p < s->numberOfProcs; p++)
+      fprintf(out, "%s%"PRId32, (p > 0) ? ", " : "", GC_affinityForProc(s, p));
+    fprintf(out, "]");
+  }
+}
+
+#endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
+
+int32_t GC_affinityForProc(GC_state s, uint32_t proc) {
+  struct GC_cpuInfo *info = &(s->controls->cpuInfo);
+  if (s->controls->affinityExplicit or 0 == info->numCpus)
+    return (int32_t)proc * s->controls->affinityStride
+           + s->controls->affinityBase;
+  return (int32_t)info->cpus[proc % info->numCpus];
+}
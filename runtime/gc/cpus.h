@@ -0,0 +1,35 @@
+#ifndef CPUS_H_
+#define CPUS_H_
+
+#if (defined (MLTON_GC_INTERNAL_TYPES))
+
+/* The processors this process may use, found at startup (see cpus.c). */
+struct GC_cpuInfo {
+  uint32_t *cpus;      /* allowed CPUs, in increasing order */
+  uint32_t numCpus;
+  double cgroupQuota;  /* cgroup CPU limit in CPUs, or 0.0 if unlimited */
+};
+
+#endif /* (defined (MLTON_GC_INTERNAL_TYPES)) */
+
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+void detectCpus(GC_state s);
+uint32_t autoNumberOfProcs(GC_state s);
+/* The socket (physical package) of the CPU that worker `proc` is pinned to,
+ * or UINT32_MAX if workers are not pinned or the topology is unknown. */
+uint32_t packageForProc(GC_state s, uint32_t proc);
+void checkAffinity(GC_state s);
+void displayCpuInfo(FILE *out, GC_state s);
+void displayCpuInfoJSON(FILE *out, GC_state s);
+
+#endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
+
+#if (defined (MLTON_GC_INTERNAL_BASIS))
+
+/* The CPU that worker `proc` is pinned to by `@mpl set-affinity`. */
+PRIVATE int32_t GC_affinityForProc(GC_state s, uint32_t proc);
+
+#endif /* (defined (MLTON_GC_INTERNAL_BASIS)) */
+
+#endif /* CPUS_H_ */
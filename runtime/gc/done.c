@@ -52,11 +52,21 @@ static void displayHHAllocStats(FILE *out, GC_state s) {
   fprintf(out, "num hh allocated: %zu\n", numFixedSizeAllocated(fsa));
   fprintf(out, "num hh freed: %zu\n", numFixedSizeFreed(fsa));
   fprintf(out, "num hh shared freed: %zu\n", numFixedSizeSharedFreed(fsa));
+  fprintf(out, "num hh shared free batches: %zu\n", numFixedSizeSharedBatches(fsa));
   fprintf(out, "num hh currently in use: %zu\n", numFixedSizeCurrentlyInUse(fsa));
   fprintf(out, "current hh alloc capacity: %zu\n", currentFixedSizeCapacity(fsa));
   fprintf(out, "current hh space util: %.1f%%\n",
           100.0 * currentFixedSizeSpaceUtilization(fsa));
 
+  if (NULL != s->hhEBR) {
+    fprintf(out, "num hh retired: %zu\n", EBR_numRetired(s->hhEBR, s->procNumber));
+    fprintf(out, "num hh reclaimed: %zu\n", EBR_numFreed(s->hhEBR, s->procNumber));
+    fprintf(out, "max hh awaiting reclamation: %zu\n", EBR_maxLimbo(s->hhEBR, s->procNumber));
+    fprintf(out, "hh awaiting reclamation over time:");
+    EBR_displayLimboSamples(out, s->hhEBR, s->procNumber);
+    fprintf(out, "\n");
+  }
+
   size_t maxSize = 0;
   size_t maxHeight = 0;
   for (HM_HierarchicalHeap cursor = getHierarchicalHeapCurrent(s);
@@ -148,6 +158,12 @@ static void displayCumulativeStatistics (FILE *out, struct GC_cumulativeStatisti
            uintmaxToCommaString (cumulativeStatistics->maxHHLCHS));
   fprintf (out, "max stack size: %s bytes\n",
            uintmaxToCommaString (cumulativeStatistics->maxStackSize));
+  fprintf (out, "num steals: %s\n",
+           uintmaxToCommaString (cumulativeStatistics->numSteals));
+  fprintf (out, "num heartbeat signals: %s\n",
+           uintmaxToCommaString (cumulativeStatistics->numHeartbeatSignals));
+  fprintf (out, "num parks: %s\n",
+           uintmaxToCommaString (cumulativeStatistics->numParks));
   fprintf (out, "num cards marked: %s\n",
            uintmaxToCommaString (cumulativeStatistics->numCardsMarked));
   fprintf (out, "bytes scanned: %s bytes\n",
@@ -213,6 +229,17 @@ static void displayCumulativeStatisticsJSON (FILE *out, GC_state s) {
 
     fprintf(out, ", ");
 
+    displayCpuInfoJSON(out, s);
+
+    if (NULL != s->hhEBR) {
+      fprintf(out, ", \"hhEBR\" : ");
+      EBR_outputJSON(out, s->hhEBR, s->numberOfProcs);
+    }
+    if (NULL != s->hmEBR) {
+      fprintf(out, ", \"hmEBR\" : ");
+      EBR_outputJSON(out, s->hmEBR, s->numberOfProcs);
+    }
+
     // SAM_NOTE: TODO: removed for now; will need to replace with blocks statistics
     // fprintf(out,
     //         "\"maxChunkPoolOccupancy\" : %"PRIuMAX,
@@ -266,6 +293,7 @@ void GC_done(GC_state s) {
   if (s->controls->summary) {
     if (HUMAN == s->controls->summaryFormat) {
       fprintf (s->controls->summaryFile, "Global::\n");
+      displayCpuInfo (s->controls->summaryFile, s);
       displayGlobalCumulativeStatistics
               (s->controls->summaryFile,
                s->globalCumulativeStatistics);
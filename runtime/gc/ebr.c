@@ -32,6 +32,23 @@
 
 #define ANNOUNCEMENT_PADDING 16
 
+/** Advancing the epoch requires having seen every processor in the current
+ * epoch (or quiescent). Each leaveQuiescentState checks up to
+ * EBR_CHECKS_PER_LEAVE announcements, so with P processors an epoch can
+ * advance after about P/EBR_CHECKS_PER_LEAVE operations instead of P.
+ * Once a processor holds EBR_EAGER_LIMBO unreclaimed objects, it scans
+ * the whole array on each operation, which bounds its limbo garbage
+ * whenever the other processors are making progress.
+ *
+ * Announcements are checked in each processor's scanOrder, which puts the
+ * processors on its own socket first (when workers are pinned with
+ * set-affinity). A processor that is behind is then most often found
+ * without reading announcements across sockets.
+ */
+#define EBR_CHECKS_PER_LEAVE 4
+#define EBR_EAGER_LIMBO 4096
+#define EBR_FIRST_SAMPLE_INTERVAL 10
+
 static inline size_t getAnnouncement(EBR_shared ebr, uint32_t pid)
 {
   return ebr->announce[ANNOUNCEMENT_PADDING * pid];
@@ -48,6 +65,34 @@ void EBR_enterQuiescentState(GC_state s, EBR_shared ebr)
   setAnnouncement(ebr, mypid, SET_Q_TRUE(getAnnouncement(ebr, mypid)));
 }
 
+static uint64_t elapsedMs(EBR_shared ebr)
+{
+  struct timespec now;
+  timespec_now(&now);
+  timespec_sub(&now, &(ebr->startTime));
+  return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+static void sampleLimbo(EBR_shared ebr, struct EBR_local *local)
+{
+  uint64_t ms = elapsedMs(ebr);
+  if (ms < local->nextSample)
+    return;
+
+  if (local->numSamples == EBR_LIMBO_SAMPLES)
+  {
+    for (uint32_t i = 0; i < EBR_LIMBO_SAMPLES / 2; i++)
+      local->samples[i] = local->samples[2 * i];
+    local->numSamples = EBR_LIMBO_SAMPLES / 2;
+    local->sampleInterval *= 2;
+  }
+  local->samples[local->numSamples].ms = ms;
+  local->samples[local->numSamples].limbo =
+    local->numRetired - local->numFreed;
+  local->numSamples++;
+  local->nextSample = ms + local->sampleInterval;
+}
+
 static void rotateAndReclaim(GC_state s, EBR_shared ebr)
 {
   uint32_t mypid = s->procNumber;
@@ -66,6 +111,7 @@ static void rotateAndReclaim(GC_state s, EBR_shared ebr)
          p += sizeof(void *))
     {
       ebr->freeFun(s, *(void **)p);
+      ebr->local[mypid].numFreed++;
       // HM_UnionFindNode hufp = *(HM_UnionFindNode *)p;
       // assert(hufp->payload != NULL);
       // freeFixedSize(getHHAllocator(s), hufp->payload);
@@ -87,6 +133,11 @@ EBR_shared EBR_new(GC_state s, EBR_freeRetiredObj freeFun)
   ebr->local =
       malloc(s->numberOfProcs * sizeof(struct EBR_local));
   ebr->freeFun = freeFun;
+  timespec_now(&(ebr->startTime));
+
+  uint32_t *packages = malloc_safe(s->numberOfProcs * sizeof(uint32_t));
+  for (uint32_t i = 0; i < s->numberOfProcs; i++)
+    packages[i] = packageForProc(s, i);
 
   for (uint32_t i = 0; i < s->numberOfProcs; i++)
   {
@@ -94,9 +145,27 @@ EBR_shared EBR_new(GC_state s, EBR_freeRetiredObj freeFun)
     setAnnouncement(ebr, i, PACK(0, 0));
     ebr->local[i].limboIdx = 0;
     ebr->local[i].checkNext = 0;
+    ebr->local[i].numRetired = 0;
+    ebr->local[i].numFreed = 0;
+    ebr->local[i].maxLimbo = 0;
+    ebr->local[i].numSamples = 0;
+    ebr->local[i].sampleInterval = EBR_FIRST_SAMPLE_INTERVAL;
+    ebr->local[i].nextSample = 0;
     for (int j = 0; j < 3; j++)
       HM_initChunkList(&(ebr->local[i].limboBags[j]));
+
+    uint32_t *order = malloc_safe(s->numberOfProcs * sizeof(uint32_t));
+    uint32_t n = 0;
+    for (uint32_t j = 0; j < s->numberOfProcs; j++)
+      if (packages[j] == packages[i])
+        order[n++] = j;
+    for (uint32_t j = 0; j < s->numberOfProcs; j++)
+      if (packages[j] != packages[i])
+        order[n++] = j;
+    ebr->local[i].scanOrder = order;
   }
+
+  free(packages);
   return ebr;
 }
 
@@ -117,17 +186,25 @@ void EBR_leaveQuiescentState(GC_state s, EBR_shared ebr)
      * bag of the epoch we're moving into.
      */
     rotateAndReclaim(s, ebr);
+    sampleLimbo(ebr, &(ebr->local[mypid]));
   }
-  // write a function which takes a number of reads of otherann as an argument
-  uint32_t otherpid = (ebr->local[mypid].checkNext) % numProcs;
-  size_t otherann = getAnnouncement(ebr, otherpid);
-  if (UNPACK_EPOCH(otherann) == globalEpoch || UNPACK_QBIT(otherann))
+  struct EBR_local *local = &(ebr->local[mypid]);
+  uint32_t budget =
+    (local->numRetired - local->numFreed >= EBR_EAGER_LIMBO)
+    ? numProcs
+    : EBR_CHECKS_PER_LEAVE;
+  while (budget > 0 && local->checkNext < numProcs)
   {
-    uint32_t c = ++ebr->local[mypid].checkNext;
-    if (c >= numProcs)
-    {
-      __sync_val_compare_and_swap(&(ebr->epoch), globalEpoch, globalEpoch + 1);
-    }
+    size_t otherann =
+      getAnnouncement(ebr, local->scanOrder[local->checkNext]);
+    if (UNPACK_EPOCH(otherann) != globalEpoch && !UNPACK_QBIT(otherann))
+      break;
+    local->checkNext++;
+    budget--;
+  }
+  if (local->checkNext >= numProcs)
+  {
+    __sync_val_compare_and_swap(&(ebr->epoch), globalEpoch, globalEpoch + 1);
   }
 
   setAnnouncement(ebr, mypid, PACK(globalEpoch, 0));
@@ -136,6 +213,10 @@ void EBR_leaveQuiescentState(GC_state s, EBR_shared ebr)
 void EBR_retire(GC_state s, EBR_shared ebr, void *ptr)
 {
   uint32_t mypid = s->procNumber;
+  struct EBR_local *local = &(ebr->local[mypid]);
+  local->numRetired++;
+  if (local->numRetired - local->numFreed > local->maxLimbo)
+    local->maxLimbo = local->numRetired - local->numFreed;
   int limboIdx = ebr->local[mypid].limboIdx;
   HM_chunkList limboBag = &(ebr->local[mypid].limboBags[limboIdx]);
   HM_chunk chunk = HM_getChunkListLastChunk(limboBag);
@@ -167,4 +248,48 @@ void EBR_retire(GC_state s, EBR_shared ebr, void *ptr)
   return;
 }
 
+size_t EBR_numRetired(EBR_shared ebr, uint32_t pid)
+{
+  return ebr->local[pid].numRetired;
+}
+
+size_t EBR_numFreed(EBR_shared ebr, uint32_t pid)
+{
+  return ebr->local[pid].numFreed;
+}
+
+size_t EBR_maxLimbo(EBR_shared ebr, uint32_t pid)
+{
+  return ebr->local[pid].maxLimbo;
+}
+
+void EBR_displayLimboSamples(FILE *out, EBR_shared ebr, uint32_t pid)
+{
+  struct EBR_local *local = &(ebr->local[pid]);
+  for (uint32_t i = 0; i < local->numSamples; i++)
+    fprintf(out, " %"PRIu64"ms:%zu",
+            local->samples[i].ms, local->samples[i].limbo);
+}
+
+void EBR_outputJSON(FILE *out, EBR_shared ebr, uint32_t numProcs)
+{
+  fprintf(out, "[");
+  for (uint32_t pid = 0; pid < numProcs; pid++)
+  {
+    struct EBR_local *local = &(ebr->local[pid]);
+    if (pid > 0)
+      fprintf(out, ", ");
+    fprintf(out, "{ \"retired\" : %zu", local->numRetired);
+    fprintf(out, ", \"reclaimed\" : %zu", local->numFreed);
+    fprintf(out, ", \"maxLimbo\" : %zu", local->maxLimbo);
+    fprintf(out, ", \"limboSamples\" : [");
+    for (uint32_t i = 0; i < local->numSamples; i++)
+      fprintf(out, "%s{ \"ms\" : %"PRIu64", \"limbo\" : %zu }",
+              (i > 0) ? ", " : "",
+              local->samples[i].ms, local->samples[i].limbo);
+    fprintf(out, "] }");
+  }
+  fprintf(out, "]");
+}
+
 #endif // MLTON_GC_INTERNAL_FUNCS
@@ -13,11 +13,42 @@
 
 #if (defined(MLTON_GC_INTERNAL_TYPES))
 
+#define EBR_LIMBO_SAMPLES 64
+
+struct EBR_limboSample
+{
+  uint64_t ms;    /* milliseconds since EBR_new */
+  size_t limbo;   /* numRetired - numFreed at that time */
+};
+
 struct EBR_local
 {
   struct HM_chunkList limboBags[3];
   int limboIdx;
   uint32_t checkNext;
+
+  /* The order in which this processor checks announcements: the
+   * processors on its own socket first, then the others.
+   */
+  uint32_t *scanOrder;
+
+  /* Statistics. Objects retired but not yet freed are limbo garbage:
+   *   numRetired - numFreed
+   * maxLimbo is the most limbo garbage this processor ever held.
+   */
+  size_t numRetired;
+  size_t numFreed;
+  size_t maxLimbo;
+
+  /* Limbo garbage over time, sampled when the processor moves into a new
+   * epoch, at most once every sampleInterval ms. When the buffer fills up,
+   * every other sample is dropped and the interval doubles, so the samples
+   * always cover the whole run.
+   */
+  struct EBR_limboSample samples[EBR_LIMBO_SAMPLES];
+  uint32_t numSamples;
+  uint64_t sampleInterval;
+  uint64_t nextSample;
 } __attribute__((aligned(128)));
 
 typedef void (*EBR_freeRetiredObj) (GC_state s, void *ptr);
@@ -35,6 +66,8 @@ typedef struct EBR_shared
   struct EBR_local *local;
 
   EBR_freeRetiredObj freeFun;
+
+  struct timespec startTime;
 } * EBR_shared;
 
 #else
@@ -52,6 +85,12 @@ void EBR_enterQuiescentState(GC_state s, EBR_shared ebr);
 void EBR_leaveQuiescentState(GC_state s, EBR_shared ebr);
 void EBR_retire(GC_state s, EBR_shared ebr, void *ptr);
 
+size_t EBR_numRetired(EBR_shared ebr, uint32_t pid);
+size_t EBR_numFreed(EBR_shared ebr, uint32_t pid);
+size_t EBR_maxLimbo(EBR_shared ebr, uint32_t pid);
+void EBR_displayLimboSamples(FILE *out, EBR_shared ebr, uint32_t pid);
+void EBR_outputJSON(FILE *out, EBR_shared ebr, uint32_t numProcs);
+
 #endif // MLTON_GC_INTERNAL_FUNCS
 
 #endif // EBR_H_
@@ -20,7 +20,14 @@ void initFixedSizeAllocator(
   fsa->numAllocated = 0;
   fsa->numLocalFreed = 0;
   fsa->numSharedFreed = 0;
+  fsa->numSharedBatches = 0;
   fsa->purpose = purpose;
+  for (int i = 0; i < FIXED_SIZE_PENDING_SLOTS; i++) {
+    fsa->pending[i].owner = NULL;
+    fsa->pending[i].first = NULL;
+    fsa->pending[i].last = NULL;
+    fsa->pending[i].count = 0;
+  }
   return;
 }
 
@@ -103,6 +110,32 @@ void* allocateFixedSize(FixedSizeAllocator fsa) {
 }
 
 
+static inline size_t pendingSlotOf(FixedSizeAllocator owner) {
+  uint64_t h = (uint64_t)(uintptr_t)owner * UINT64_C(0x9E3779B97F4A7C15);
+  return (size_t)(h >> 32) % FIXED_SIZE_PENDING_SLOTS;
+}
+
+
+static void publishPending(struct FixedSizePending *slot) {
+  if (0 == slot->count)
+    return;
+
+  FixedSizeAllocator owner = slot->owner;
+  while (true) {
+    struct FixedSizeElement *oldVal = owner->sharedFreeList;
+    slot->last->nextFree = oldVal;
+    if (__sync_bool_compare_and_swap(&(owner->sharedFreeList), oldVal, slot->first))
+      break;
+  }
+  __sync_fetch_and_add(&(owner->numSharedFreed), slot->count);
+  __sync_fetch_and_add(&(owner->numSharedBatches), (size_t)1);
+
+  slot->first = NULL;
+  slot->last = NULL;
+  slot->count = 0;
+}
+
+
 void freeFixedSize(FixedSizeAllocator myfsa, void* arg) {
   HM_chunk chunk = HM_getChunkOf((pointer)arg);
   pointer gap = HM_getChunkStartGap(chunk);
@@ -122,15 +155,26 @@ void freeFixedSize(FixedSizeAllocator myfsa, void* arg) {
     return;
   }
 
-  /** Slow path: concurrent insertion into other shared freelist.
+  /** Slow path: buffer the element in a batch for its owner. The batch is
+    * pushed onto the owner's shared freelist with a single CAS when it is
+    * evicted from its slot, or at the next flushFixedSizeFrees.
     */
-  while (true) {
-    struct FixedSizeElement *oldVal = owner->sharedFreeList;
-    elem->nextFree = oldVal;
-    if (__sync_bool_compare_and_swap(&(owner->sharedFreeList), oldVal, elem))
-      break;
+  struct FixedSizePending *slot = &(myfsa->pending[pendingSlotOf(owner)]);
+  if (slot->owner != owner) {
+    publishPending(slot);
+    slot->owner = owner;
   }
-  __sync_fetch_and_add(&(owner->numSharedFreed), (size_t)1);
+  elem->nextFree = slot->first;
+  if (NULL == slot->first)
+    slot->last = elem;
+  slot->first = elem;
+  slot->count++;
+}
+
+
+void flushFixedSizeFrees(FixedSizeAllocator myfsa) {
+  for (int i = 0; i < FIXED_SIZE_PENDING_SLOTS; i++)
+    publishPending(&(myfsa->pending[i]));
 }
 
 
@@ -143,6 +187,10 @@ size_t numFixedSizeSharedFreed(FixedSizeAllocator fsa) {
   return fsa->numSharedFreed;
 }
 
+size_t numFixedSizeSharedBatches(FixedSizeAllocator fsa) {
+  return fsa->numSharedBatches;
+}
+
 size_t numFixedSizeFreed(FixedSizeAllocator fsa) {
   return fsa->numLocalFreed + fsa->numSharedFreed;
 }
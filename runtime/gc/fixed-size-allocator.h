@@ -13,6 +13,19 @@ struct FixedSizeElement {
   struct FixedSizeElement *nextFree;
 };
 
+#define FIXED_SIZE_PENDING_SLOTS 8
+
+/** A batch of elements freed by this allocator's processor that belong to
+  * some other allocator [owner]. The elements are chained through nextFree,
+  * from [first] to [last].
+  */
+struct FixedSizePending {
+  struct FixedSizeAllocator *owner;
+  struct FixedSizeElement *first;
+  struct FixedSizeElement *last;
+  size_t count;
+};
+
 typedef struct FixedSizeAllocator {
   /** The size of each element.
     * Must be >= sizeof(struct FixedSizeElement), because when an object is
@@ -25,10 +38,14 @@ typedef struct FixedSizeAllocator {
     *   numCurrentlyInUse = numAllocated - numFreed
     *   currentCapacity = totalSize(buffer) / fixedSize
     *   spaceUtilization = numCurrentlyInUse / currentCapacity
+    *   avgSharedBatch = numSharedFreed / numSharedBatches
+    * Elements still sitting in some other allocator's pending batch are not
+    * yet counted as freed.
     */
   size_t numAllocated;
   size_t numLocalFreed;
   size_t numSharedFreed;
+  size_t numSharedBatches;
   enum BlockPurpose purpose;
 
   /** A bit of a hack. I just want quick access to pages to store elements.
@@ -46,12 +63,17 @@ typedef struct FixedSizeAllocator {
     * owns an object, we have to use this list, because the
     * owner's allocator could concurrently be in use.)
     *
-    * TODO: flat-combining for these frees? I.e. use a bump-buffer of elements
-    * returned, and then when a new allocation request comes in, move all of
-    * these elements to the fast free list.
+    * Other processors push whole batches onto it (see [pending]), and the
+    * owner takes the entire list in one CAS on its next allocation miss.
     */
   struct FixedSizeElement *sharedFreeList;
 
+  /** Elements this processor freed on behalf of other allocators, waiting
+    * to be published to their owners' shared lists in bulk. A small
+    * direct-mapped table keyed by owner; a collision publishes the slot.
+    */
+  struct FixedSizePending pending[FIXED_SIZE_PENDING_SLOTS];
+
 } *FixedSizeAllocator;
 
 #else
@@ -93,13 +115,23 @@ void* allocateFixedSize(FixedSizeAllocator fsa);
   * [myfsa], it will be pushed onto the fast (not-safe-for-concurrency)
   * free-list. This way, if a processor frees an object that it itself
   * allocated, freeing will be fast!
+  *
+  * Objects owned by other allocators are buffered in [myfsa] and only
+  * become reusable by their owner after [flushFixedSizeFrees(myfsa)].
   */
 void freeFixedSize(FixedSizeAllocator myfsa, void* elem);
 
 
+/** Publish every batch buffered by [freeFixedSize] to its owner. Must be
+  * called by the processor that owns [myfsa].
+  */
+void flushFixedSizeFrees(FixedSizeAllocator myfsa);
+
+
 size_t numFixedSizeAllocated(FixedSizeAllocator fsa);
 size_t numFixedSizeFreed(FixedSizeAllocator fsa);
 size_t numFixedSizeSharedFreed(FixedSizeAllocator fsa);
+size_t numFixedSizeSharedBatches(FixedSizeAllocator fsa);
 size_t numFixedSizeCurrentlyInUse(FixedSizeAllocator fsa);
 size_t currentFixedSizeCapacity(FixedSizeAllocator fsa);
 double currentFixedSizeSpaceUtilization(FixedSizeAllocator fsa);
@@ -26,10 +26,15 @@ void FREE_DTOA_LOCK(int n) {
   }
 }
 
+/* Each processor gets its own gdtoa freelist (see set_max_gdtoa_threads),
+ * which it uses without locking. Threads that are not MPL processors must
+ * not share processor 0's slot; an out-of-range number sends them to
+ * gdtoa's shared, lock-protected fallback instead.
+ */
 unsigned int dtoa_get_threadno(void) {
   GC_state s = pthread_getspecific(gcstate_key);
   if (NULL != s) {
     return (unsigned int)(s->procNumber);
   }
-  return 0;
+  return UINT_MAX;
 }
@@ -224,6 +224,9 @@ void GC_handler (int signum) {
 
   // int me = Proc_processorNumber(s);
 
+  if (signum == SIGALRM || signum == SIGUSR1)
+    s->cumulativeStatistics->numHeartbeatSignals++;
+
   if (s->controls->heartbeatStats && (signum == SIGALRM || signum == SIGUSR1)) {
     struct timespec now;
     timespec_now(&now);
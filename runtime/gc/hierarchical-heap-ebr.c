@@ -25,6 +25,9 @@ void HH_EBR_init(GC_state s) {
 
 void HH_EBR_leaveQuiescentState(GC_state s) {
   EBR_leaveQuiescentState(s, s->hhEBR);
+  /* Hand any records reclaimed above back to the processors that own them. */
+  flushFixedSizeFrees(getHHAllocator(s));
+  flushFixedSizeFrees(getUFAllocator(s));
 }
 
 void HH_EBR_retire(GC_state s, HM_UnionFindNode hhuf) {
@@ -1353,6 +1353,9 @@ void HM_HH_freeAllDependants(
     }
   }
 
+  if (!retireInsteadOfFree)
+    flushFixedSizeFrees(myUFAllocator);
+
   assert(numFreed == hh->numDependants);
   hh->numDependants = 0;
   hh->heightDependants = 0;
@@ -27,6 +27,18 @@ size_t sizeofInitialBytesLive (GC_state s) {
   return total;
 }
 
+/* A global that references an object of the initial dynamic heap. */
+struct initDynHeapRef {
+  pointer p;
+  uint32_t global;
+};
+
+static int compareInitDynHeapRefs(const void *a, const void *b) {
+  pointer pa = ((const struct initDynHeapRef *)a)->p;
+  pointer pb = ((const struct initDynHeapRef *)b)->p;
+  return (pa > pb) - (pa < pb);
+}
+
 void initDynHeap(GC_state s, GC_thread thread) {
   assert(0 == thread->currentDepth);
 
@@ -38,6 +50,26 @@ void initDynHeap(GC_state s, GC_thread thread) {
   pointer p = start;
   size_t metaDataSize = 0, objectSize = 0;
 
+  // The whole initial dynamic heap is still copied into chunks. Adopting it
+  // in place would need the static heap to be emitted with block-aligned
+  // HM_chunk headers, which the code generators do not do.
+  //
+  // Globals that reference the initial dynamic heap, sorted by address, so
+  // that each segment adjusts only the globals pointing into it, in
+  // O(globals log globals) rather than O(globals) per segment.
+  struct initDynHeapRef *refs =
+    malloc_safe((s->globalsLength + 1) * sizeof(struct initDynHeapRef));
+  uint32_t numRefs = 0, nextRef = 0;
+  for (uint32_t i = 0; i < s->globalsLength; i++) {
+    pointer g = objptrToPointer(s->globals[i], NULL);
+    if (start <= g && g < end) {
+      refs[numRefs].p = g;
+      refs[numRefs].global = i;
+      numRefs++;
+    }
+  }
+  qsort(refs, numRefs, sizeof(struct initDynHeapRef), compareInitDynHeapRefs);
+
   // While there are segments of the initial dynamic heap to be copied
   // into the root hierarchical heap.
   while (1) {
@@ -81,12 +113,11 @@ void initDynHeap(GC_state s, GC_thread thread) {
     // Copy segment `[start,p)` into current segment.
     memcpy (frontier, start, p - start);
     // Adjust global objptrs that referenced an object in the segment.
-    for (uint32_t i = 0; i < s->globalsLength; i++) {
-      pointer g = objptrToPointer(s->globals[i], NULL);
-      if (start <= g && g < p) {
-        g = (g - start) + frontier;
-        s->globals[i] = pointerToObjptr(g, NULL);
-      }
+    while (nextRef < numRefs && refs[nextRef].p < p) {
+      assert(start <= refs[nextRef].p);
+      pointer g = (refs[nextRef].p - start) + frontier;
+      s->globals[refs[nextRef].global] = pointerToObjptr(g, NULL);
+      nextRef++;
     }
     // Advance frontier.
     frontier += p - start;
@@ -107,6 +138,9 @@ void initDynHeap(GC_state s, GC_thread thread) {
     }
   }
 
+  assert(nextRef == numRefs);
+  free(refs);
+
   /* If the last allocation passed a block boundary, we need to extend to have
    * a valid frontier. Extending with GC_HEAP_LIMIT_SLOP is arbitrary. */
   if (!inFirstBlockOfChunk(currentChunk, frontier + GC_SEQUENCE_METADATA_SIZE)) {
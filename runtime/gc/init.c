@@ -200,11 +200,31 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           if (i == argc || (0 == strcmp (argv[i], "--")))
             die ("%s affinity-base missing argument.", atName);
           s->controls->affinityBase = stringToInt (argv[i++]);
+          s->controls->affinityExplicit = TRUE;
         } else if (0 == strcmp (arg, "affinity-stride")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--")))
             die ("%s affinity-stride missing argument.", atName);
           s->controls->affinityStride = stringToInt (argv[i++]);
+          s->controls->affinityExplicit = TRUE;
+        } else if (0 == strcmp (arg, "active-procs")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s active-procs missing argument.", atName);
+          if (0 == strcmp (argv[i], "auto")) {
+            s->controls->activeProcsAuto = TRUE;
+            s->controls->activeProcs = 0;
+            i++;
+          } else {
+            int n = stringToInt (argv[i++]);
+            if (n < 1)
+              die ("%s active-procs argument must be at least 1.", atName);
+            s->controls->activeProcsAuto = FALSE;
+            s->controls->activeProcs = (uint32_t)n;
+          }
+        } else if (0 == strcmp (arg, "affinity-skip-smt")) {
+          i++;
+          s->controls->affinitySkipSMT = TRUE;
         } else if (0 == strcmp (arg, "debug-keep-free-blocks")) {
           i++;
           s->controls->debugKeepFreeBlocks = TRUE;
@@ -229,6 +249,9 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           if (i == argc || (0 == strcmp (argv[i], "--")))
             die ("%s heartbeat-relayer-threshold missing argument.", atName);
           s->controls->heartbeatRelayerThreshold = stringToInt (argv[i++]);
+        } else if (0 == strcmp (arg, "lazy-promotion")) {
+          i++;
+          s->controls->lazyPromotion = TRUE;
         } else if (0 == strcmp (arg, "load-world")) {
           unless (s->controls->mayLoadWorld)
             die ("May not load world.");
@@ -338,7 +361,13 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
             die ("%s %s missing argument.", atName, arg);
           if (!s->amOriginal)
             die ("%s %s incompatible with loaded worlds.", atName, arg);
-          s->numberOfProcs = stringToFloat (argv[i++]);
+          if (0 == strcmp (argv[i], "auto")) {
+            s->controls->procsAuto = TRUE;
+            i++;
+          } else {
+            s->controls->procsAuto = FALSE;
+            s->numberOfProcs = stringToFloat (argv[i++]);
+          }
           /* Turn off loaded worlds -- they are unsuppoed in multi-proc mode */
           s->controls->mayLoadWorld = FALSE;
         } else if ( (0 == strcmp(arg, "min-chunk")) ||
@@ -528,6 +557,11 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->controls->setAffinity = FALSE;
   s->controls->affinityBase = 0;
   s->controls->affinityStride = 1;
+  s->controls->affinityExplicit = FALSE;
+  s->controls->affinitySkipSMT = FALSE;
+  s->controls->procsAuto = FALSE;
+  s->controls->activeProcs = 0;
+  s->controls->activeProcsAuto = FALSE;
   s->controls->ratios.ramSlop = 0.5f;
   s->controls->ratios.stackCurrentGrow = 2.0f;
   s->controls->ratios.stackCurrentMaxReserved = 32.0f;
@@ -561,6 +595,7 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->controls->heartbeatMicroseconds = 500;
   s->controls->heartbeatTokens = 30;
   s->controls->heartbeatRelayerThreshold = 16;
+  s->controls->lazyPromotion = FALSE;
 
   /* Not arbitrary; should be at least the page size and must also respect the
    * limit check coalescing amount in the compiler. */
@@ -622,6 +657,14 @@ int GC_init (GC_state s, int argc, char **argv) {
   L_setFile(stderr);
   processAtMLton (s, 0, s->atMLtonsLength, s->atMLtons, &s->worldFile);
   res = processAtMLton (s, 1, argc, argv, &s->worldFile);
+  detectCpus (s);
+  if (s->controls->procsAuto)
+    s->numberOfProcs = autoNumberOfProcs (s);
+  checkAffinity (s);
+  if (s->controls->activeProcsAuto)
+    GC_setActiveProcessors (s, autoNumberOfProcs (s));
+  else if (0 != s->controls->activeProcs)
+    GC_setActiveProcessors (s, s->controls->activeProcs);
   unless (s->controls->ratios.stackCurrentPermitReserved
           <= s->controls->ratios.stackCurrentMaxReserved)
     die ("Ratios must satisfy stack-current-permit-reserved <= stack-current-max-reserved.");
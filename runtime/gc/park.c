@@ -0,0 +1,115 @@
+/* Parking idle workers.
+ *
+ * A worker that has been idle for a while parks: instead of spinning in the
+ * scheduler's steal loop, it blocks on a condition variable and gives up its
+ * CPU. Publishing new work hands out wake-up tickets, each of which releases
+ * one parked worker. Parked workers also return on their own after
+ * PARK_TIMEOUT_NS, which bounds the delay when a wake-up races with parking.
+ *
+ * Workers numbered at or above the active-processor limit park as soon as
+ * they run out of work and stay parked (without timeouts) until the limit is
+ * raised. The limit never drops below 1, so worker 0 is always active.
+ *
+ * `@mpl active-procs N` sets the initial limit. `@mpl active-procs auto`
+ * starts it at the cgroup CPU quota (rounded up, see cpus.c) and lets the
+ * scheduler move it between 1 and that value according to how much time
+ * the active workers spend idle.
+ */
+
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+#define PARK_TIMEOUT_NS 10000000
+
+static pthread_mutex_t parkLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t parkCond = PTHREAD_COND_INITIALIZER;
+
+/* All protected by parkLock; numParked is also read racily as a hint. */
+static uint32_t numParked = 0;
+static uint32_t wakeTickets = 0;
+static uint32_t activeProcessors = 0; /* 0 means all of them */
+
+static inline bool isActiveProcessor(GC_state s) {
+  return 0 == activeProcessors || (uint32_t)s->procNumber < activeProcessors;
+}
+
+static void parkDeadline(struct timespec *deadline) {
+  clock_gettime(CLOCK_REALTIME, deadline);
+  deadline->tv_nsec += PARK_TIMEOUT_NS;
+  if (deadline->tv_nsec >= 1000000000) {
+    deadline->tv_sec += 1;
+    deadline->tv_nsec -= 1000000000;
+  }
+}
+
+void wakeParkedWorkersForTermination(void) {
+  pthread_mutex_lock(&parkLock);
+  pthread_cond_broadcast(&parkCond);
+  pthread_mutex_unlock(&parkLock);
+}
+
+#endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
+
+void GC_parkWorker(GC_state s) {
+  /* A parked worker must not hold up epoch advancement for the others, and
+   * must not sit on frees that belong to other processors. */
+  flushFixedSizeFrees(getHHAllocator(s));
+  flushFixedSizeFrees(getUFAllocator(s));
+  HH_EBR_enterQuiescentState(s);
+  HM_EBR_enterQuiescentState(s);
+
+  struct timespec deadline;
+  parkDeadline(&deadline);
+
+  pthread_mutex_lock(&parkLock);
+  numParked++;
+  s->cumulativeStatistics->numParks++;
+  while (!GC_CheckForTerminationRequest(s)) {
+    if (!isActiveProcessor(s)) {
+      pthread_cond_wait(&parkCond, &parkLock);
+      parkDeadline(&deadline);
+      continue;
+    }
+    if (wakeTickets > 0) {
+      wakeTickets--;
+      break;
+    }
+    if (ETIMEDOUT == pthread_cond_timedwait(&parkCond, &parkLock, &deadline))
+      break;
+  }
+  numParked--;
+  if (wakeTickets > numParked)
+    wakeTickets = numParked;
+  pthread_mutex_unlock(&parkLock);
+}
+
+void GC_unparkWorkers(__attribute__ ((unused)) GC_state s, uint32_t n) {
+  if (0 == atomicLoadU32(&numParked))
+    return;
+
+  pthread_mutex_lock(&parkLock);
+  uint32_t tickets = wakeTickets + n;
+  wakeTickets = (tickets < numParked) ? tickets : numParked;
+  pthread_cond_broadcast(&parkCond);
+  pthread_mutex_unlock(&parkLock);
+}
+
+void GC_setActiveProcessors(GC_state s, uint32_t n) {
+  if (n < 1)
+    n = 1;
+  if (n > s->numberOfProcs)
+    n = s->numberOfProcs;
+
+  pthread_mutex_lock(&parkLock);
+  activeProcessors = n;
+  pthread_cond_broadcast(&parkCond);
+  pthread_mutex_unlock(&parkLock);
+}
+
+bool GC_getActiveProcessorsAuto(GC_state s) {
+  return s->controls->activeProcsAuto;
+}
+
+uint32_t GC_getActiveProcessors(GC_state s) {
+  uint32_t n = atomicLoadU32(&activeProcessors);
+  return (0 == n) ? s->numberOfProcs : n;
+}
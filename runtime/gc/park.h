@@ -0,0 +1,30 @@
+#ifndef PARK_H_
+#define PARK_H_
+
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+/* Wake every parked worker so that it can observe a termination request. */
+void wakeParkedWorkersForTermination(void);
+
+#endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
+
+#if (defined (MLTON_GC_INTERNAL_BASIS))
+
+/* Block the calling (idle) worker until it is handed a wake-up by
+ * GC_unparkWorkers, a timeout expires, or termination is requested.
+ * Workers at or above the active-processor limit stay blocked until
+ * the limit is raised.
+ */
+PRIVATE void GC_parkWorker(GC_state s);
+
+/* Hand out up to n wake-ups to parked workers. Cheap when none are parked. */
+PRIVATE void GC_unparkWorkers(GC_state s, uint32_t n);
+
+PRIVATE void GC_setActiveProcessors(GC_state s, uint32_t n);
+PRIVATE uint32_t GC_getActiveProcessors(GC_state s);
+/* Whether `@mpl active-procs auto` was given. */
+PRIVATE bool GC_getActiveProcessorsAuto(GC_state s);
+
+#endif /* (defined (MLTON_GC_INTERNAL_BASIS)) */
+
+#endif /* PARK_H_ */
@@ -119,7 +119,6 @@ void HM_foreachPublic (
   }
 
   HM_chunk chunk = (remSet->public).firstChunk;
-  HM_chunk lastChunk = CC_getLastChunk (&(remSet->public));
   int array_size = 2 * s->numberOfProcs;
   FishyChunk* fishyChunks = malloc(sizeof(struct FishyChunk) * array_size);
   int numFishyChunks = 0;
@@ -144,11 +143,9 @@ void HM_foreachPublic (
       chunk = chunk->nextChunk;
     }
     checkFishyChunks(s, fishyChunks, numFishyChunks, f);
-    lastChunk = CC_getLastChunk(&(remSet->public));
-    if (lastChunk != fishyChunks[numFishyChunks - 1].chunk) {
-      assert (chunk->nextChunk != NULL);
-      chunk = chunk->nextChunk;
-    }
+    /* Chunks may have been installed past the one we stopped at. */
+    chunk = CC_getNextChunk(&(remSet->public),
+                            fishyChunks[numFishyChunks - 1].chunk);
   }
   free(fishyChunks);
   struct HM_chunkList _chunkList;
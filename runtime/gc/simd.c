@@ -0,0 +1,166 @@
+/* See simd.h for the conventions shared by these kernels. Loads and stores
+ * go through memcpy because sequence elements are only guaranteed to be
+ * aligned to their own size.
+ */
+
+#define LOAD(v, p) memcpy (&(v), (p), SIMD_BYTES)
+#define STORE(p, v) memcpy ((p), &(v), SIMD_BYTES)
+
+double GC_simdReal64Sum (pointer a, size_t aoff, size_t n) {
+  const double *p = (const double *)a + aoff;
+  Real64x2 acc0 = {0.0, 0.0}, acc1 = {0.0, 0.0};
+  size_t i = 0;
+  for (; i + SIMD_STRIDE <= n; i += SIMD_STRIDE) {
+    Real64x2 v0, v1;
+    LOAD (v0, p + i);
+    LOAD (v1, p + i + 2);
+    acc0 += v0;
+    acc1 += v1;
+  }
+  double r = (acc0[0] + acc1[0]) + (acc0[1] + acc1[1]);
+  for (; i < n; i++)
+    r += p[i];
+  return r;
+}
+
+double GC_simdReal64Dot (pointer a, size_t aoff, pointer b, size_t boff, size_t n) {
+  const double *p = (const double *)a + aoff;
+  const double *q = (const double *)b + boff;
+  Real64x2 acc0 = {0.0, 0.0}, acc1 = {0.0, 0.0};
+  size_t i = 0;
+  for (; i + SIMD_STRIDE <= n; i += SIMD_STRIDE) {
+    Real64x2 x0, x1, y0, y1;
+    LOAD (x0, p + i);
+    LOAD (x1, p + i + 2);
+    LOAD (y0, q + i);
+    LOAD (y1, q + i + 2);
+    acc0 += x0 * y0;
+    acc1 += x1 * y1;
+  }
+  double r = (acc0[0] + acc1[0]) + (acc0[1] + acc1[1]);
+  for (; i < n; i++)
+    r += p[i] * q[i];
+  return r;
+}
+
+/* A NaN anywhere in the slice makes the result NaN. The lanes only keep
+ * values that compare greater, which a NaN never does, so NaNs are
+ * tracked separately, in the vector loop and the scalar tail alike.
+ */
+double GC_simdReal64MaxAbs (pointer a, size_t aoff, size_t n) {
+  const double *p = (const double *)a + aoff;
+  const Int64x2 signMask = {INT64_MAX, INT64_MAX};
+  Real64x2 acc0 = {0.0, 0.0}, acc1 = {0.0, 0.0};
+  Int64x2 nan = {0, 0};
+  size_t i = 0;
+  for (; i + SIMD_STRIDE <= n; i += SIMD_STRIDE) {
+    Real64x2 v0, v1;
+    LOAD (v0, p + i);
+    LOAD (v1, p + i + 2);
+    v0 = (Real64x2)((Int64x2)v0 & signMask);
+    v1 = (Real64x2)((Int64x2)v1 & signMask);
+    nan |= (v0 != v0) | (v1 != v1);
+    Int64x2 m0 = v0 > acc0;
+    Int64x2 m1 = v1 > acc1;
+    acc0 = (Real64x2)(((Int64x2)v0 & m0) | ((Int64x2)acc0 & ~m0));
+    acc1 = (Real64x2)(((Int64x2)v1 & m1) | ((Int64x2)acc1 & ~m1));
+  }
+  double r = max (max (acc0[0], acc1[0]), max (acc0[1], acc1[1]));
+  bool sawNaN = (0 != (nan[0] | nan[1]));
+  for (; i < n; i++) {
+    double x = fabs (p[i]);
+    if (isnan (x))
+      sawNaN = TRUE;
+    else if (x > r)
+      r = x;
+  }
+  return sawNaN ? NAN : r;
+}
+
+void GC_simdReal64Axpy (double alpha, pointer x, size_t xoff, pointer y, size_t yoff, size_t n) {
+  const double *p = (const double *)x + xoff;
+  double *q = (double *)y + yoff;
+  const Real64x2 va = {alpha, alpha};
+  size_t i = 0;
+  for (; i + SIMD_STRIDE <= n; i += SIMD_STRIDE) {
+    Real64x2 x0, x1, y0, y1;
+    LOAD (x0, p + i);
+    LOAD (x1, p + i + 2);
+    LOAD (y0, q + i);
+    LOAD (y1, q + i + 2);
+    y0 = va * x0 + y0;
+    y1 = va * x1 + y1;
+    STORE (q + i, y0);
+    STORE (q + i + 2, y1);
+  }
+  for (; i < n; i++)
+    q[i] = alpha * p[i] + q[i];
+}
+
+void GC_simdReal64Scale (double alpha, pointer a, size_t aoff, size_t n) {
+  double *p = (double *)a + aoff;
+  const Real64x2 va = {alpha, alpha};
+  size_t i = 0;
+  for (; i + SIMD_STRIDE <= n; i += SIMD_STRIDE) {
+    Real64x2 v0, v1;
+    LOAD (v0, p + i);
+    LOAD (v1, p + i + 2);
+    v0 = va * v0;
+    v1 = va * v1;
+    STORE (p + i, v0);
+    STORE (p + i + 2, v1);
+  }
+  for (; i < n; i++)
+    p[i] = alpha * p[i];
+}
+
+void GC_simdReal64Fma (pointer d, size_t doff,
+                       pointer a, size_t aoff,
+                       pointer b, size_t boff,
+                       pointer c, size_t coff,
+                       size_t n) {
+  double *r = (double *)d + doff;
+  const double *p = (const double *)a + aoff;
+  const double *q = (const double *)b + boff;
+  const double *s = (const double *)c + coff;
+  size_t i = 0;
+  /* All inputs of an iteration are loaded before anything is stored, so d
+   * may alias a, b or c at the same offset.
+   */
+  for (; i + SIMD_STRIDE <= n; i += SIMD_STRIDE) {
+    Real64x2 a0, a1, b0, b1, c0, c1;
+    LOAD (a0, p + i);
+    LOAD (a1, p + i + 2);
+    LOAD (b0, q + i);
+    LOAD (b1, q + i + 2);
+    LOAD (c0, s + i);
+    LOAD (c1, s + i + 2);
+    c0 = a0 * b0 + c0;
+    c1 = a1 * b1 + c1;
+    STORE (r + i, c0);
+    STORE (r + i + 2, c1);
+  }
+  for (; i < n; i++)
+    r[i] = p[i] * q[i] + s[i];
+}
+
+uint32_t GC_simdWord32Sum (pointer a, size_t aoff, size_t n) {
+  const uint32_t *p = (const uint32_t *)a + aoff;
+  Word32x4 acc0 = {0, 0, 0, 0}, acc1 = {0, 0, 0, 0};
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    Word32x4 v0, v1;
+    LOAD (v0, p + i);
+    LOAD (v1, p + i + 4);
+    acc0 += v0;
+    acc1 += v1;
+  }
+  acc0 += acc1;
+  uint32_t r = (acc0[0] + acc0[1]) + (acc0[2] + acc0[3]);
+  for (; i < n; i++)
+    r += p[i];
+  return r;
+}
+
+#undef LOAD
+#undef STORE
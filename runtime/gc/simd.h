@@ -0,0 +1,54 @@
+/** Lane-parallel kernels over unboxed Real64 and Word32 sequences.
+ *
+ * Each kernel takes a pointer to the start of a sequence together with an
+ * element offset and length, as produced by ArraySlice.base. The loops are
+ * written with GCC vector extensions, so they are lowered to whatever vector
+ * instructions the target supports (SSE2/AVX on amd64, NEON on arm64), and to
+ * scalar code otherwise.
+ *
+ * Vectors are 128 bits wide, the width available on every target, and the
+ * loops process two vectors per iteration. Reductions accumulate in
+ * SIMD_STRIDE independent lanes and combine the lanes in a fixed order.
+ * Results are therefore deterministic, but may differ in the last bits from
+ * a sequential left-to-right fold.
+ */
+
+#ifndef SIMD_H_
+#define SIMD_H_
+
+#if (defined (MLTON_GC_INTERNAL_TYPES))
+
+#define SIMD_BYTES 16
+/* elements consumed per iteration of a Real64 loop */
+#define SIMD_STRIDE (2 * SIMD_BYTES / sizeof (double))
+
+typedef double Real64x2 __attribute__ ((vector_size (SIMD_BYTES)));
+typedef int64_t Int64x2 __attribute__ ((vector_size (SIMD_BYTES)));
+typedef uint32_t Word32x4 __attribute__ ((vector_size (SIMD_BYTES)));
+
+#endif /* MLTON_GC_INTERNAL_TYPES */
+
+#if (defined (MLTON_GC_INTERNAL_BASIS))
+
+/* sum of a[aoff..aoff+n) */
+PRIVATE double GC_simdReal64Sum (pointer a, size_t aoff, size_t n);
+/* sum of a[aoff+i] * b[boff+i] */
+PRIVATE double GC_simdReal64Dot (pointer a, size_t aoff, pointer b, size_t boff, size_t n);
+/* max of |a[aoff+i]|, 0.0 if n = 0, NaN if any a[aoff+i] is NaN */
+PRIVATE double GC_simdReal64MaxAbs (pointer a, size_t aoff, size_t n);
+/* y[yoff+i] := alpha * x[xoff+i] + y[yoff+i] */
+PRIVATE void GC_simdReal64Axpy (double alpha, pointer x, size_t xoff, pointer y, size_t yoff, size_t n);
+/* a[aoff+i] := alpha * a[aoff+i] */
+PRIVATE void GC_simdReal64Scale (double alpha, pointer a, size_t aoff, size_t n);
+/* d[doff+i] := a[aoff+i] * b[boff+i] + c[coff+i], possibly fused */
+PRIVATE void GC_simdReal64Fma (pointer d, size_t doff,
+                               pointer a, size_t aoff,
+                               pointer b, size_t boff,
+                               pointer c, size_t coff,
+                               size_t n);
+/* sum (mod 2^32) of a[aoff..aoff+n) */
+PRIVATE uint32_t GC_simdWord32Sum (pointer a, size_t aoff, size_t n);
+
+#endif /* MLTON_GC_INTERNAL_BASIS */
+
+#endif /* SIMD_H_ */
@@ -339,6 +339,13 @@ pointer getPromoStackOldestPromotableFrame(
   GC_state s,
   GC_stack stack)
 {
+  /* Without a promo stack, the whole stack is walked. This moves the cost of
+   * tracking promotable frames from every call inside a spork to each
+   * promotion.
+   */
+  if (s->controls->lazyPromotion)
+    return findPromotableFrame(s, stack);
+
   size_t num_frames = 0;
   pointer* bot = (pointer*)stack->promoStackBot;
   while ((pointer)bot < stack->promoStackTop && !frameIsPromotable(s, *bot)) {
@@ -372,6 +379,9 @@ void updatePromoStackOldestPromotableFrame(
   GC_state s,
   GC_stack stack)
 {
+  if (s->controls->lazyPromotion)
+    return;
+
   size_t num_frames = 0;
   pointer* bot = (pointer*)stack->promoStackBot;
   while ((pointer)bot < stack->promoStackTop && !frameIsPromotable(s, *bot)) {
@@ -396,7 +406,6 @@ void updatePromoStackOldestPromotableFrame(
 }
 
 
-#if ASSERT
 pointer findPromotableFrame (GC_state s, GC_stack stack) {
 
   pointer top = getStackTop(s, stack);
@@ -429,7 +438,6 @@ pointer findPromotableFrame (GC_state s, GC_stack stack) {
 
   return oldestPromotableFrame;
 }
-#endif // ASSERT
 
 
 #if ASSERT
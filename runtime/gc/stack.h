@@ -108,8 +108,8 @@ static inline size_t sizeofStackGrowReserved (GC_state s, GC_stack stack);
 static inline size_t sizeofStackShrinkReserved (GC_state s, GC_stack stack, bool current);
 
 // pointer to frame that is promotable, or NULL if no such frame
-#if ASSERT
 pointer findPromotableFrame (GC_state s, GC_stack stack);
+#if ASSERT
 pointer findYoungestPromotableFrame (GC_state s, GC_stack stack);
 #endif
 pointer getPromoStackOldestPromotableFrame (GC_state s, GC_stack stack);
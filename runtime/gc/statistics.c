@@ -73,6 +73,9 @@ struct GC_cumulativeStatistics *newCumulativeStatistics(void) {
   cumulativeStatistics->numCCs = 0;
   cumulativeStatistics->numDisentanglementChecks = 0;
   cumulativeStatistics->numEntanglements = 0;
+  cumulativeStatistics->numParks = 0;
+  cumulativeStatistics->numSteals = 0;
+  cumulativeStatistics->numHeartbeatSignals = 0;
   cumulativeStatistics->numChecksSkipped = 0;
   cumulativeStatistics->numSuspectsMarked = 0;
   cumulativeStatistics->numSuspectsCleared = 0;
@@ -272,6 +275,20 @@ void S_outputCumulativeStatisticsJSON(
     fprintf(out, ", ");
 
     fprintf(out, "\"bytesHashConsed\" : %"PRIuMAX, statistics->bytesHashConsed);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numSteals\" : %"PRIuMAX, statistics->numSteals);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"numHeartbeatSignals\" : %"PRIuMAX,
+            statistics->numHeartbeatSignals);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numParks\" : %"PRIuMAX, statistics->numParks);
   }
   fprintf(out, " }");
 }
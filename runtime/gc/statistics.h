@@ -70,6 +70,9 @@ struct GC_cumulativeStatistics {
   uintmax_t numCCs;
   uintmax_t numDisentanglementChecks; // count full read barriers
   uintmax_t numEntanglements;         // count instances entanglement is detected
+  uintmax_t numParks;                 // times this processor parked while idle
+  uintmax_t numSteals;                // tasks this processor stole
+  uintmax_t numHeartbeatSignals;      // heartbeat signals received
   uintmax_t numChecksSkipped;
   uintmax_t numSuspectsMarked;
   uintmax_t numSuspectsCleared;
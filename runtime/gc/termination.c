@@ -92,6 +92,7 @@ bool GC_TryToTerminate(GC_state s) {
   for (uint32_t p = 0; p < s->numberOfProcs; p++)
     if (p != myself)
       s->procStates[p].limit = 0;
+  wakeParkedWorkersForTermination();
 
   Trace0(EVENT_HALT_WAIT);
 
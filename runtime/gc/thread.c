@@ -525,7 +525,8 @@ objptr GC_HH_forkThread(
    * non-promotable frame at the bottom of the promo stack; we can check
    * this here.
    */
-  assert(!youngestOptimization || fromStack->promoStackTop == fromStack->promoStackBot + sizeof(pointer)
+  assert(!youngestOptimization || s->controls->lazyPromotion
+                               || fromStack->promoStackTop == fromStack->promoStackBot + sizeof(pointer)
                                || fromStack->promoStackTop == fromStack->promoStackBot + 2*sizeof(pointer));
 #endif
 